@@ -0,0 +1,45 @@
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+#ifdef COUNT_ALLOCATIONS
+
+static thread_local long long countAllocations = 0;
+
+long long AllocationCounter::getCount() { return countAllocations; }
+bool AllocationCounter::isEnabled() { return true; }
+
+// Every other form of operator new and delete in the standard library forwards to these.
+void* operator new(std::size_t size) {
+    countAllocations++;
+    if (void* memory = std::malloc(size > 0 ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+#else
+
+long long AllocationCounter::getCount() { return 0; }
+bool AllocationCounter::isEnabled() { return false; }
+
+#endif
@@ -0,0 +1,24 @@
+#pragma once
+#include <cassert>
+
+//Debug builds replace the global operator new so heap allocations can be counted.  Define
+//COUNT_ALLOCATIONS in a release build to count there too.
+#if !defined(COUNT_ALLOCATIONS) && !defined(NDEBUG)
+#define COUNT_ALLOCATIONS
+#endif
+
+
+
+class AllocationCounter
+{
+public:
+	//The number of allocations made so far by the calling thread.  Counting per thread keeps work on
+	//other threads, like the save writer, from showing up in the game loop or a search.
+	static long long getCount();
+	static bool isEnabled();
+
+	static void assertNoneSince(long long countBefore) {
+		assert(getCount() == countBefore && "Heap allocation where none is allowed.");
+		(void)countBefore;
+	}
+};
@@ -1,31 +1,13 @@
 #include "Checker.h"
+#include "KingAttacks.h"
 #include <algorithm> // Required for std::max
+#include <cstdlib>
 
-SDL_Texture* Checker::textureRedKing = nullptr;
-SDL_Texture* Checker::textureRedRegular = nullptr;
-SDL_Texture* Checker::textureBlueKing = nullptr;
-SDL_Texture* Checker::textureBlueRegular = nullptr;
-
-Checker::Checker(int setPosX, int setPosY, Team setTeam)
-    : posX(setPosX), posY(setPosY), team(setTeam), isAKing(false) { // Initialize isAKing
-}
-
-void Checker::loadTextures(SDL_Renderer* renderer) {
-    //textureRedKing = TextureLoader::loadTexture("Checker Red King.bmp", renderer);
-    //textureRedRegular = TextureLoader::loadTexture("Checker Red Regular.bmp", renderer);
-    //textureBlueKing = TextureLoader::loadTexture("Checker Blue King.bmp", renderer);
-    //textureBlueRegular = TextureLoader::loadTexture("Checker Blue Regular.bmp", renderer);
-    textureRedKing = TextureLoader::loadTexture("raspberryking.bmp", renderer);
-    textureRedRegular = TextureLoader::loadTexture("raspberry.bmp", renderer);
-    textureBlueKing = TextureLoader::loadTexture("blueberryking.bmp", renderer);
-    textureBlueRegular = TextureLoader::loadTexture("blueberry.bmp", renderer);
+Checker::Checker(int setPosX, int setPosY, Team setTeam, bool setIsAKing)
+    : posX(setPosX), posY(setPosY), team(setTeam), isAKing(setIsAKing) {
 }
 
-void Checker::draw(SDL_Renderer* renderer, int squareSizePixels) {
-    draw(renderer, squareSizePixels, posX, posY, false); // Ensure it calls the correct overload
-}
-
-void Checker::drawPossibleMoves(SDL_Renderer* renderer, int squareSizePixels, std::vector<Checker>& listCheckers, bool canOnlyMove2Squares) {
+void Checker::listPossibleMoves(CheckerList& listCheckers, bool canOnlyMove2Squares, TargetList& listPositions) {
     // For each direction, check how far we can move
     for (int xDir : {-1, 1}) {
         for (int yDir : {-1, 1}) {
@@ -33,23 +15,22 @@ void Checker::drawPossibleMoves(SDL_Renderer* renderer, int squareSizePixels, st
 
             if (maxDistance > 0) {
                 if (isAKing) {
-                    // For kings, draw all valid positions along the diagonal
+                    // For kings, list all valid positions along the diagonal
                     for (int dist = 1; dist <= maxDistance; dist++) {
                         int newX = posX + (xDir * dist);
                         int newY = posY + (yDir * dist);
 
-                        // If in capture-only mode, only show positions that result in captures
+                        // If in capture-only mode, only list positions that result in captures
                         if (!canOnlyMove2Squares ||
                             willCaptureInPath(posX, posY, newX, newY, xDir, yDir, listCheckers)) {
-                            draw(renderer, squareSizePixels, newX, newY, true);
+                            listPositions.push_back({ newX, newY });
                         }
                     }
                 }
                 else {
-                    // For regular pieces, just show the maximum valid move
+                    // For regular pieces, just list the maximum valid move
                     if (!canOnlyMove2Squares || maxDistance == 2) {
-                        draw(renderer, squareSizePixels, posX + (xDir * maxDistance),
-                            posY + (yDir * maxDistance), true);
+                        listPositions.push_back({ posX + (xDir * maxDistance), posY + (yDir * maxDistance) });
                     }
                 }
             }
@@ -57,7 +38,7 @@ void Checker::drawPossibleMoves(SDL_Renderer* renderer, int squareSizePixels, st
     }
 }
 
-int Checker::checkHowFarCanMoveInAnyDirection(std::vector<Checker>& listCheckers) {
+int Checker::checkHowFarCanMoveInAnyDirection(CheckerList& listCheckers) {
     // Check if the piece can make any valid moves
     int maxDistance = std::max({
         checkHowFarCanMoveInDirection(1, 1, listCheckers),
@@ -71,7 +52,7 @@ int Checker::checkHowFarCanMoveInAnyDirection(std::vector<Checker>& listCheckers
 
 // Function to determine if moving from one position to another will result in a capture
 bool Checker::willCaptureInPath(int startX, int startY, int endX, int endY,
-    int xDir, int yDir, std::vector<Checker>& listCheckers) {
+    int xDir, int yDir, CheckerList& listCheckers) {
     int x = startX;
     int y = startY;
     bool foundOpponent = false;
@@ -100,7 +81,7 @@ bool Checker::willCaptureInPath(int startX, int startY, int endX, int endY,
     return false;
 }
 
-int Checker::tryToMoveToPosition(int x, int y, std::vector<Checker>& listCheckers, int& indexCheckerErase, bool canOnlyMove2Squares) {
+int Checker::tryToMoveToPosition(int x, int y, CheckerList& listCheckers, int& indexCheckerErase, bool canOnlyMove2Squares) {
     if (x == posX && y == posY) return 0; // Prevent self-move
 
     int xDirection = (x > posX) ? 1 : -1;
@@ -149,10 +130,7 @@ int Checker::tryToMoveToPosition(int x, int y, std::vector<Checker>& listChecker
                 // Ensure the landing square is valid
                 if (findCheckerAtPosition(nextX, nextY, listCheckers) == nullptr) {
                     jumpedOverPiece = true;
-                    indexCheckerErase = std::distance(listCheckers.begin(),
-                        std::find_if(listCheckers.begin(), listCheckers.end(),
-                            [xMovable, yMovable](Checker& c) {
-                                return c.posX == xMovable && c.posY == yMovable; }));
+                    indexCheckerErase = listCheckers.indexOf(checkerSelected);
                 }
                 else {
                     return 0; // Can't jump if landing square is occupied
@@ -180,52 +158,30 @@ int Checker::tryToMoveToPosition(int x, int y, std::vector<Checker>& listChecker
 int Checker::getPosX() { return posX; }
 int Checker::getPosY() { return posY; }
 Checker::Team Checker::getTeam() { return team; }
-
-// Fixed draw function for consistent rendering of both pieces and preview
-void Checker::draw(SDL_Renderer* renderer, int squareSizePixels, int x, int y, bool drawTransparent) {
-    SDL_Texture* textureDrawSelected = nullptr;
-
-    switch (team) {
-    case Team::red:
-        textureDrawSelected = (isAKing ? textureRedKing : textureRedRegular);
-        break;
-    case Team::blue:
-        textureDrawSelected = (isAKing ? textureBlueKing : textureBlueRegular);
-        break;
-    }
-
-    if (textureDrawSelected) {
-        // Set transparency level - 128 for preview (half transparent), 255 for actual pieces
-        SDL_SetTextureAlphaMod(textureDrawSelected, drawTransparent ? 128 : 255);
-
-        // Calculate the position with offset
-        int offsetX = 192;
-        int offsetY = 192;
-        SDL_Rect rect = {
-            offsetX + (x * squareSizePixels),
-            offsetY + (y * squareSizePixels),
-            squareSizePixels,
-            squareSizePixels
-        };
-
-        // Render the texture
-        SDL_RenderCopy(renderer, textureDrawSelected, nullptr, &rect);
-
-        // Reset alpha to full opacity for other renders
-        if (drawTransparent) {
-            SDL_SetTextureAlphaMod(textureDrawSelected, 255);
-        }
-    }
-}
+bool Checker::getIsAKing() { return isAKing; }
 
 // Fixed checkHowFarCanMoveInDirection function with corrected king logic
-int Checker::checkHowFarCanMoveInDirection(int xDirection, int yDirection, std::vector<Checker>& listCheckers) {
+int Checker::checkHowFarCanMoveInDirection(int xDirection, int yDirection, CheckerList& listCheckers) {
     if (abs(xDirection) != 1 || abs(yDirection) != 1) return 0;
 
     // Regular checkers can only move forward based on their team
     if (!isAKing && ((team == Team::red && yDirection < 0) || (team == Team::blue && yDirection > 0)))
         return 0;
 
+    // For kings, look up the whole diagonal at once instead of walking it square by square
+    if (isAKing) {
+        uint64_t occupancyOpponent = 0;
+        uint64_t occupancy = KingAttacks::getOccupancy(listCheckers, team, occupancyOpponent);
+        const KingAttacks::Ray& ray = KingAttacks::getRay(posX, posY, xDirection, yDirection, occupancy);
+
+        // Kings can capture but stop at the square right behind the opponent's piece
+        if (ray.squareLanding != -1 && ((occupancyOpponent >> ray.squareBlocker) & 1))
+            return ray.distanceEmpty + 2; // +2 represents jumping over the opponent piece
+
+        // Otherwise the king can move over every empty square up to the first piece or the edge
+        return ray.distanceEmpty;
+    }
+
     int x = posX + xDirection;
     int y = posY + yDirection;
 
@@ -249,56 +205,17 @@ int Checker::checkHowFarCanMoveInDirection(int xDirection, int yDirection, std::
             // Check if the landing square is valid
             if (jumpX >= 0 && jumpX < 10 && jumpY >= 0 && jumpY < 10 &&
                 !findCheckerAtPosition(jumpX, jumpY, listCheckers)) {
-                // Can capture - kings stop after capturing just like regular pieces
                 return 2;
             }
             return 0;
         }
     }
 
-    // For kings, check how far we can move without capturing
-    if (isAKing) {
-        int maxDistance = 1; // We can at least move 1 square
-
-        // Continue checking empty squares along the diagonal
-        while (true) {
-            x += xDirection;
-            y += yDirection;
-
-            if (x < 0 || x >= 10 || y < 0 || y >= 10) break; // Check bounds
-
-            Checker* nextChecker = findCheckerAtPosition(x, y, listCheckers);
-            if (nextChecker) {
-                // Found a piece - if opponent's piece, check for capture
-                if (nextChecker->team != team) {
-                    int jumpX = x + xDirection;
-                    int jumpY = y + yDirection;
-
-                    // Check if we can capture
-                    if (jumpX >= 0 && jumpX < 10 && jumpY >= 0 && jumpY < 10 &&
-                        !findCheckerAtPosition(jumpX, jumpY, listCheckers)) {
-                        // Kings can capture but stop at the capturing position (jumpX, jumpY)
-                        // Return the distance to the capture landing position
-                        return maxDistance + 2; // +2 represents jumping over the opponent piece
-                    }
-                }
-                // Blocked by any piece (opponent with no capture or friendly)
-                break;
-            }
-
-            // Empty square - increase maximum distance
-            maxDistance++;
-        }
-
-        return maxDistance;
-    }
-    else {
-        // Regular pieces can only move 1 square without capturing
-        return 1;
-    }
+    // Regular pieces can only move 1 square without capturing
+    return 1;
 }
 
-bool Checker::canCaptureInAnyDirection(std::vector<Checker>& listCheckers) { //newly added
+bool Checker::canCaptureInAnyDirection(CheckerList& listCheckers) { //newly added
     // Check all four diagonal directions for possible captures
     for (int xDir : {-1, 1}) {
         for (int yDir : {-1, 1}) {
@@ -333,7 +250,7 @@ bool Checker::canCaptureInAnyDirection(std::vector<Checker>& listCheckers) { //n
     return false; // No captures available
 }
 
-Checker* Checker::findCheckerAtPosition(int x, int y, std::vector<Checker>& listCheckers) {
+Checker* Checker::findCheckerAtPosition(int x, int y, CheckerList& listCheckers) {
     for (auto& checker : listCheckers)
         if (checker.posX == x && checker.posY == y)
             return &checker;
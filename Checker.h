@@ -1,8 +1,19 @@
 #pragma once
-#include <vector>
 #include <algorithm>
-#include "SDL2/SDL.h"
-#include "TextureLoader.h"
+#include <utility>
+#include "FixedList.h"
+class Checker;
+//Only pointers to these are needed here, so the rules can be built without SDL.  The drawing code is in CheckerDraw.cpp.
+struct SDL_Renderer;
+struct SDL_Texture;
+
+//Every checker on the board, one for each dark square at most.
+typedef FixedList<Checker, 50> CheckerList;
+//The squares a single checker can move to, a king can reach at most 17 from any square.
+typedef FixedList<std::pair<int, int>, 20> TargetList;
+
+
+
 class Checker
 {
 public:
@@ -11,26 +22,35 @@ public:
 		blue
 	};
 public:
-	Checker(int setPosX, int setPosY, Team setTeam);
+	Checker() = default;
+	Checker(int setPosX, int setPosY, Team setTeam, bool setIsAKing = false);
 	static void loadTextures(SDL_Renderer* renderer);
-	void draw(SDL_Renderer* renderer, int squareSizePixels);
-	void drawPossibleMoves(SDL_Renderer* renderer, int squareSizePixels, std::vector<Checker>& listCheckers, bool canOnlyMove2Squares);
-	int checkHowFarCanMoveInAnyDirection(std::vector<Checker>& listCheckers);
-	int tryToMoveToPosition(int x, int y, std::vector<Checker>& listCheckers, int& indexCheckerErase, bool canOnlyMove2Squares);
+	static void updateScaledTextures(SDL_Renderer* renderer, int squareSizePixels);
+	static void destroyScaledTextures();
+	void draw(SDL_Renderer* renderer, int squareSizePixels, int offsetX, int offsetY);
+	void drawPossibleMoves(SDL_Renderer* renderer, int squareSizePixels, int offsetX, int offsetY, CheckerList& listCheckers, bool canOnlyMove2Squares);
+	void listPossibleMoves(CheckerList& listCheckers, bool canOnlyMove2Squares, TargetList& listPositions);
+	int checkHowFarCanMoveInAnyDirection(CheckerList& listCheckers);
+	int tryToMoveToPosition(int x, int y, CheckerList& listCheckers, int& indexCheckerErase, bool canOnlyMove2Squares);
 	int getPosX();
 	int getPosY();
 	Team getTeam();
+	bool getIsAKing();
 	static void resetCurrentMoveDirection();
-	bool canCaptureInAnyDirection(std::vector<Checker>& listCheckers); //newly added
+	bool canCaptureInAnyDirection(CheckerList& listCheckers); //newly added
 private:
-	bool willCaptureInPath(int startX, int startY, int endX, int endY, int xDir, int yDir, std::vector<Checker>& listCheckers);
-	void draw(SDL_Renderer* renderer, int squareSizePixels, int x, int y, bool drawTransparent = false);
-	int checkHowFarCanMoveInDirection(int xDirection, int yDirection, std::vector<Checker>& listCheckers);
-	Checker* findCheckerAtPosition(int x, int y, std::vector<Checker>& listCheckers);
-	int posX, posY;
-	Team team;
+	bool willCaptureInPath(int startX, int startY, int endX, int endY, int xDir, int yDir, CheckerList& listCheckers);
+	void draw(SDL_Renderer* renderer, int squareSizePixels, int offsetX, int offsetY, int x, int y, bool drawTransparent = false);
+	static SDL_Texture* createScaledTexture(SDL_Renderer* renderer, SDL_Texture* textureSource, int sizePixels);
+	int checkHowFarCanMoveInDirection(int xDirection, int yDirection, CheckerList& listCheckers);
+	Checker* findCheckerAtPosition(int x, int y, CheckerList& listCheckers);
+	int posX = 0, posY = 0;
+	Team team = Team::red;
 	bool isAKing = false;
 	static SDL_Texture* textureRedKing, * textureRedRegular,
 		* textureBlueKing, * textureBlueRegular;
+	//Copies of the textures above scaled to the size of a square, so drawing them doesn't need any scaling.
+	static SDL_Texture* textureRedKingScaled, * textureRedRegularScaled,
+		* textureBlueKingScaled, * textureBlueRegularScaled;
 	static int currentMoveDirection; // 0=none, 1=downRight, 2=downLeft, 3=upRight, 4=upLeft
 };
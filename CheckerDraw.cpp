@@ -0,0 +1,117 @@
+#include "Checker.h"
+#include "TextureLoader.h"
+
+SDL_Texture* Checker::textureRedKing = nullptr;
+SDL_Texture* Checker::textureRedRegular = nullptr;
+SDL_Texture* Checker::textureBlueKing = nullptr;
+SDL_Texture* Checker::textureBlueRegular = nullptr;
+SDL_Texture* Checker::textureRedKingScaled = nullptr;
+SDL_Texture* Checker::textureRedRegularScaled = nullptr;
+SDL_Texture* Checker::textureBlueKingScaled = nullptr;
+SDL_Texture* Checker::textureBlueRegularScaled = nullptr;
+
+void Checker::loadTextures(SDL_Renderer* renderer) {
+    //textureRedKing = TextureLoader::loadTexture("Checker Red King.bmp", renderer);
+    //textureRedRegular = TextureLoader::loadTexture("Checker Red Regular.bmp", renderer);
+    //textureBlueKing = TextureLoader::loadTexture("Checker Blue King.bmp", renderer);
+    //textureBlueRegular = TextureLoader::loadTexture("Checker Blue Regular.bmp", renderer);
+    textureRedKing = TextureLoader::loadTexture("raspberryking.bmp", renderer);
+    textureRedRegular = TextureLoader::loadTexture("raspberry.bmp", renderer);
+    textureBlueKing = TextureLoader::loadTexture("blueberryking.bmp", renderer);
+    textureBlueRegular = TextureLoader::loadTexture("blueberry.bmp", renderer);
+}
+
+void Checker::updateScaledTextures(SDL_Renderer* renderer, int squareSizePixels) {
+    // Scale each texture once here instead of every time a checker is drawn.
+    destroyScaledTextures();
+    textureRedKingScaled = createScaledTexture(renderer, textureRedKing, squareSizePixels);
+    textureRedRegularScaled = createScaledTexture(renderer, textureRedRegular, squareSizePixels);
+    textureBlueKingScaled = createScaledTexture(renderer, textureBlueKing, squareSizePixels);
+    textureBlueRegularScaled = createScaledTexture(renderer, textureBlueRegular, squareSizePixels);
+}
+
+void Checker::destroyScaledTextures() {
+    for (SDL_Texture** textureScaled : { &textureRedKingScaled, &textureRedRegularScaled,
+        &textureBlueKingScaled, &textureBlueRegularScaled }) {
+        if (*textureScaled != nullptr) {
+            SDL_DestroyTexture(*textureScaled);
+            *textureScaled = nullptr;
+        }
+    }
+}
+
+SDL_Texture* Checker::createScaledTexture(SDL_Renderer* renderer, SDL_Texture* textureSource, int sizePixels) {
+    if (textureSource == nullptr || sizePixels <= 0)
+        return nullptr;
+
+    // If the renderer can't render to textures then nullptr is returned and the original texture is used instead.
+    SDL_Texture* textureScaled = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, sizePixels, sizePixels);
+    if (textureScaled == nullptr)
+        return nullptr;
+
+    SDL_Texture* textureTargetPrevious = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, textureScaled);
+
+    // Copy without blending so the scaled texture keeps the original's transparency instead of
+    // having it blended against the empty target.
+    SDL_SetTextureBlendMode(textureSource, SDL_BLENDMODE_NONE);
+    SDL_RenderCopy(renderer, textureSource, nullptr, nullptr);
+    SDL_SetTextureBlendMode(textureSource, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderTarget(renderer, textureTargetPrevious);
+    SDL_SetTextureBlendMode(textureScaled, SDL_BLENDMODE_BLEND);
+
+    return textureScaled;
+}
+
+void Checker::draw(SDL_Renderer* renderer, int squareSizePixels, int offsetX, int offsetY) {
+    draw(renderer, squareSizePixels, offsetX, offsetY, posX, posY, false); // Ensure it calls the correct overload
+}
+
+void Checker::drawPossibleMoves(SDL_Renderer* renderer, int squareSizePixels, int offsetX, int offsetY, CheckerList& listCheckers, bool canOnlyMove2Squares) {
+    TargetList listPositions;
+    listPossibleMoves(listCheckers, canOnlyMove2Squares, listPositions);
+
+    for (auto& position : listPositions)
+        draw(renderer, squareSizePixels, offsetX, offsetY, position.first, position.second, true);
+}
+
+// Fixed draw function for consistent rendering of both pieces and preview
+void Checker::draw(SDL_Renderer* renderer, int squareSizePixels, int offsetX, int offsetY, int x, int y, bool drawTransparent) {
+    SDL_Texture* textureDrawSelected = nullptr;
+
+    // Prefer the textures that are already the size of a square.
+    switch (team) {
+    case Team::red:
+        textureDrawSelected = (isAKing ? textureRedKingScaled : textureRedRegularScaled);
+        if (textureDrawSelected == nullptr)
+            textureDrawSelected = (isAKing ? textureRedKing : textureRedRegular);
+        break;
+    case Team::blue:
+        textureDrawSelected = (isAKing ? textureBlueKingScaled : textureBlueRegularScaled);
+        if (textureDrawSelected == nullptr)
+            textureDrawSelected = (isAKing ? textureBlueKing : textureBlueRegular);
+        break;
+    }
+
+    if (textureDrawSelected) {
+        // Set transparency level - 128 for preview (half transparent), 255 for actual pieces
+        SDL_SetTextureAlphaMod(textureDrawSelected, drawTransparent ? 128 : 255);
+
+        // Calculate the position with offset
+        SDL_Rect rect = {
+            offsetX + (x * squareSizePixels),
+            offsetY + (y * squareSizePixels),
+            squareSizePixels,
+            squareSizePixels
+        };
+
+        // Render the texture
+        SDL_RenderCopy(renderer, textureDrawSelected, nullptr, &rect);
+
+        // Reset alpha to full opacity for other renders
+        if (drawTransparent) {
+            SDL_SetTextureAlphaMod(textureDrawSelected, 255);
+        }
+    }
+}
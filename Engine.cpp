@@ -0,0 +1,448 @@
+#include "Engine.h"
+#include "AllocationCounter.h"
+#include "KingAttacks.h"
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+
+Engine::Engine() :
+    arenaPositions(plyMax + 1), arenaMoveLists(plyMax + 1) {
+}
+
+Engine::Position Engine::createStartPosition() {
+    // Same layout as Game::resetBoard.
+    Position position;
+    for (int x = 0; x < 10; x++) {
+        for (int y = 0; y < 10; y++) {
+            if ((x + y) % 2 == 0) {
+                if (y < 2) {
+                    position.listCheckers.push_back(Checker(x, y, Checker::Team::red));
+                }
+                else if (y >= 8) {
+                    position.listCheckers.push_back(Checker(x, y, Checker::Team::blue));
+                }
+            }
+        }
+    }
+
+    return position;
+}
+
+int Engine::squareNumberFromPosition(int x, int y) {
+    // Dark squares are numbered 1 to 50 row by row, five to a row, as in draughts notation.
+    return y * 5 + x / 2 + 1;
+}
+
+bool Engine::positionFromSquareNumber(int squareNumber, int& x, int& y) {
+    if (squareNumber < 1 || squareNumber > 50)
+        return false;
+
+    y = (squareNumber - 1) / 5;
+    x = ((squareNumber - 1) % 5) * 2 + (y % 2);
+    return true;
+}
+
+bool Engine::parsePosition(const std::string& text, Position& position) {
+    // Positions look like "R:R1,2,K3:B48,K50".  The first letter is the team to move, then each
+    // team lists its squares with a K in front of kings.
+    if (text == "startpos") {
+        position = createStartPosition();
+        return true;
+    }
+
+    std::stringstream stream(text);
+    std::string section;
+    Position positionParsed;
+    bool squareOccupied[51] = {};
+
+    if (!std::getline(stream, section, ':') || section.size() != 1)
+        return false;
+    if (section[0] == 'R')
+        positionParsed.teamSelectedForGameplay = Checker::Team::red;
+    else if (section[0] == 'B')
+        positionParsed.teamSelectedForGameplay = Checker::Team::blue;
+    else
+        return false;
+
+    while (std::getline(stream, section, ':')) {
+        if (section.empty() || (section[0] != 'R' && section[0] != 'B'))
+            return false;
+        Checker::Team team = (section[0] == 'R' ? Checker::Team::red : Checker::Team::blue);
+
+        std::stringstream streamSquares(section.substr(1));
+        std::string squareText;
+        while (std::getline(streamSquares, squareText, ',')) {
+            bool isAKing = (!squareText.empty() && squareText[0] == 'K');
+            if (isAKing)
+                squareText = squareText.substr(1);
+
+            int squareNumber = 0, x = 0, y = 0;
+            try {
+                squareNumber = std::stoi(squareText);
+            }
+            catch (...) {
+                return false;
+            }
+            if (!positionFromSquareNumber(squareNumber, x, y) || squareOccupied[squareNumber])
+                return false;
+
+            squareOccupied[squareNumber] = true;
+            positionParsed.listCheckers.push_back(Checker(x, y, team, isAKing));
+        }
+    }
+
+    position = positionParsed;
+    return true;
+}
+
+std::string Engine::formatPosition(Position& position) {
+    std::string text = (position.teamSelectedForGameplay == Checker::Team::red ? "R" : "B");
+
+    for (Checker::Team team : { Checker::Team::red, Checker::Team::blue }) {
+        // List the squares in order, kings are stored negated so they keep their place in the order.
+        std::vector<int> listSquares;
+        for (auto& checker : position.listCheckers) {
+            if (checker.getTeam() == team) {
+                int squareNumber = squareNumberFromPosition(checker.getPosX(), checker.getPosY());
+                listSquares.push_back(checker.getIsAKing() ? -squareNumber : squareNumber);
+            }
+        }
+        std::sort(listSquares.begin(), listSquares.end(), [](int a, int b) { return abs(a) < abs(b); });
+
+        text += (team == Checker::Team::red ? ":R" : ":B");
+        for (int index = 0; index < (int)listSquares.size(); index++) {
+            if (index > 0)
+                text += ",";
+            if (listSquares[index] < 0)
+                text += "K";
+            text += std::to_string(abs(listSquares[index]));
+        }
+    }
+
+    return text;
+}
+
+bool Engine::parseMove(const std::string& text, Move& move) {
+    // Moves are two square numbers separated by "-" for a move or "x" for a capture, or "pass" to
+    // end a capture sequence.
+    move = Move();
+    if (text == "pass") {
+        move.isPass = true;
+        return true;
+    }
+
+    size_t indexSeparator = text.find_first_of("-x");
+    if (indexSeparator == std::string::npos)
+        return false;
+
+    int squareFrom = 0, squareTo = 0;
+    try {
+        squareFrom = std::stoi(text.substr(0, indexSeparator));
+        squareTo = std::stoi(text.substr(indexSeparator + 1));
+    }
+    catch (...) {
+        return false;
+    }
+
+    move.isCapture = (text[indexSeparator] == 'x');
+    return positionFromSquareNumber(squareFrom, move.fromX, move.fromY) &&
+        positionFromSquareNumber(squareTo, move.toX, move.toY);
+}
+
+std::string Engine::formatMove(const Move& move) {
+    if (move.isPass)
+        return "pass";
+
+    return std::to_string(squareNumberFromPosition(move.fromX, move.fromY)) +
+        (move.isCapture ? "x" : "-") +
+        std::to_string(squareNumberFromPosition(move.toX, move.toY));
+}
+
+void Engine::generateMoves(Position& position, MoveList& listMoves) {
+    listMoves.clear();
+
+    uint64_t occupancyOpponent = 0;
+    uint64_t occupancy = KingAttacks::getOccupancy(position.listCheckers, position.teamSelectedForGameplay, occupancyOpponent);
+
+    TargetList listTargets;
+    for (int index = 0; index < (int)position.listCheckers.size(); index++) {
+        Checker& checker = position.listCheckers[index];
+        if (checker.getTeam() != position.teamSelectedForGameplay)
+            continue;
+
+        // While a capture sequence is in progress only the checker in play can move.
+        if (position.checkerInPlayCanOnlyMove2Squares && index != position.indexCheckerInPlay)
+            continue;
+
+        // A king's moves come straight from the lookup tables.  They hold exactly the squares
+        // tryToMoveToPosition accepts: every empty square up to the first piece, plus the landing
+        // square behind an opponent, and only the landing squares during a capture sequence.
+        if (checker.getIsAKing()) {
+            uint64_t squaresQuiet = 0, squaresLanding = 0;
+            KingAttacks::getKingMoves(KingAttacks::squareFromPosition(checker.getPosX(), checker.getPosY()),
+                occupancy, occupancyOpponent, squaresQuiet, squaresLanding);
+            if (position.checkerInPlayCanOnlyMove2Squares)
+                squaresQuiet = 0;
+
+            for (uint64_t* squares : { &squaresLanding, &squaresQuiet }) {
+                while (*squares != 0) {
+                    Move move;
+                    move.fromX = checker.getPosX();
+                    move.fromY = checker.getPosY();
+                    KingAttacks::positionFromSquare(KingAttacks::popLowestSquare(*squares), move.toX, move.toY);
+                    move.isCapture = (squares == &squaresLanding);
+                    listMoves.push_back(move);
+                }
+            }
+            continue;
+        }
+
+        listTargets.clear();
+        checker.listPossibleMoves(position.listCheckers, position.checkerInPlayCanOnlyMove2Squares, listTargets);
+
+        for (auto& target : listTargets) {
+            // Not every highlighted square is accepted by tryToMoveToPosition, so try the move on
+            // a copy of the checker and only keep the ones that go through.
+            Checker checkerTrial = checker;
+            int indexCheckerErase = -1;
+            if (checkerTrial.tryToMoveToPosition(target.first, target.second, position.listCheckers,
+                indexCheckerErase, position.checkerInPlayCanOnlyMove2Squares) > 0) {
+                Move move;
+                move.fromX = checker.getPosX();
+                move.fromY = checker.getPosY();
+                move.toX = target.first;
+                move.toY = target.second;
+                move.isCapture = (indexCheckerErase > -1);
+                listMoves.push_back(move);
+            }
+        }
+    }
+
+    // The player can also stop a capture sequence instead of continuing it.
+    if (position.checkerInPlayCanOnlyMove2Squares) {
+        Move move;
+        move.isPass = true;
+        listMoves.push_back(move);
+    }
+}
+
+bool Engine::isSameMove(const Move& a, const Move& b) {
+    if (a.isPass || b.isPass)
+        return a.isPass == b.isPass;
+
+    return a.fromX == b.fromX && a.fromY == b.fromY && a.toX == b.toX && a.toY == b.toY;
+}
+
+void Engine::passTurn(Position& position) {
+    position.indexCheckerInPlay = -1;
+    position.checkerInPlayCanOnlyMove2Squares = false;
+    position.teamSelectedForGameplay = (position.teamSelectedForGameplay == Checker::Team::red ?
+        Checker::Team::blue : Checker::Team::red);
+}
+
+bool Engine::applyMove(Position& position, const Move& move) {
+    // Stopping partway through a capture sequence hands the turn to the other team, as in
+    // Game::checkCheckersWithMouseInput when the checker in play can't reach the clicked square.
+    if (move.isPass) {
+        if (!position.checkerInPlayCanOnlyMove2Squares)
+            return false;
+
+        passTurn(position);
+        return true;
+    }
+
+    // Find the checker being moved.
+    int indexChecker = -1;
+    for (int index = 0; index < (int)position.listCheckers.size(); index++) {
+        Checker& checker = position.listCheckers[index];
+        if (checker.getPosX() == move.fromX && checker.getPosY() == move.fromY &&
+            checker.getTeam() == position.teamSelectedForGameplay) {
+            indexChecker = index;
+            break;
+        }
+    }
+
+    if (indexChecker == -1 ||
+        (position.checkerInPlayCanOnlyMove2Squares && indexChecker != position.indexCheckerInPlay))
+        return false;
+
+    int indexCheckerErase = -1;
+    int distanceMoved = position.listCheckers[indexChecker].tryToMoveToPosition(move.toX, move.toY,
+        position.listCheckers, indexCheckerErase, position.checkerInPlayCanOnlyMove2Squares);
+    if (distanceMoved == 0)
+        return false;
+
+    // Remove the captured checker.
+    if (indexCheckerErase > -1 && indexCheckerErase < (int)position.listCheckers.size()) {
+        position.listCheckers.erase(position.listCheckers.begin() + indexCheckerErase);
+        if (indexChecker > indexCheckerErase)
+            indexChecker--;
+    }
+
+    // A single step always ends the turn, anything longer continues if another capture is possible.
+    if (distanceMoved > 1 && position.listCheckers[indexChecker].canCaptureInAnyDirection(position.listCheckers)) {
+        position.indexCheckerInPlay = indexChecker;
+        position.checkerInPlayCanOnlyMove2Squares = true;
+    }
+    else {
+        passTurn(position);
+    }
+
+    return true;
+}
+
+int Engine::evaluate(Position& position) {
+    // Material, with a small bonus for regular checkers that have advanced towards promotion.
+    int score = 0;
+    for (auto& checker : position.listCheckers) {
+        int value = 0;
+        if (checker.getIsAKing())
+            value = 300;
+        else
+            value = 100 + 2 * (checker.getTeam() == Checker::Team::red ? checker.getPosY() : 9 - checker.getPosY());
+
+        score += (checker.getTeam() == position.teamSelectedForGameplay ? value : -value);
+    }
+
+    return score;
+}
+
+Engine::Result Engine::search(Position& position, const Limits& limits, const std::function<void(const Result&)>& onIterationDone) {
+    limitsCurrent = limits;
+    nodes = 0;
+    stopped = false;
+    hasMoveBestRoot = false;
+    timeStart = std::chrono::steady_clock::now();
+    countAllocationsSearch = 0;
+    countAllocationsSearchStart = AllocationCounter::getCount();
+
+    Result result;
+    MoveList& listMoves = arenaMoveLists[0];
+    generateMoves(position, listMoves);
+    if (listMoves.empty()) {
+        result.score = -scoreWin;
+        return result;
+    }
+
+    // Deepen one ply at a time so there's always a complete result to fall back on when a limit is hit.
+    int depthMax = (limits.depth > 0 ? std::min(limits.depth, (int)plyMax) : plyMax);
+    for (int depth = 1; depth <= depthMax && !stopped; depth++) {
+        // Search the best move from the previous iteration first.
+        if (hasMoveBestRoot) {
+            for (auto& move : listMoves) {
+                if (isSameMove(move, moveBestRoot)) {
+                    std::swap(move, listMoves[0]);
+                    break;
+                }
+            }
+        }
+
+        int alpha = -scoreWin - 1;
+        int beta = scoreWin + 1;
+        Move moveBestIteration;
+        for (auto& move : listMoves) {
+            Position& positionChild = arenaPositions[1];
+            positionChild = position;
+            applyMove(positionChild, move);
+
+            int score = (positionChild.teamSelectedForGameplay == position.teamSelectedForGameplay ?
+                searchNode(positionChild, depth - 1, alpha, beta, 1) :
+                -searchNode(positionChild, depth - 1, -beta, -alpha, 1));
+            if (stopped)
+                break;
+
+            if (score > alpha) {
+                alpha = score;
+                moveBestIteration = move;
+            }
+        }
+
+        if (stopped)
+            break;
+
+        moveBestRoot = moveBestIteration;
+        hasMoveBestRoot = true;
+
+        result.moveBest = moveBestIteration;
+        result.hasMove = true;
+        result.score = alpha;
+        result.depth = depth;
+        result.nodes = nodes;
+        result.timeMs = (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - timeStart).count();
+        result.allocations = countAllocationsSearch + (AllocationCounter::getCount() - countAllocationsSearchStart);
+        if (onIterationDone) {
+            // Whatever the callback allocates isn't part of the search, so leave it out of the count.
+            countAllocationsSearch = result.allocations;
+            onIterationDone(result);
+            countAllocationsSearchStart = AllocationCounter::getCount();
+        }
+
+        // No point searching deeper once the game is decided.
+        if (alpha >= scoreWin - 1000 || alpha <= -scoreWin + 1000)
+            break;
+    }
+
+    result.nodes = nodes;
+    result.timeMs = (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - timeStart).count();
+    result.allocations = countAllocationsSearch + (AllocationCounter::getCount() - countAllocationsSearchStart);
+    return result;
+}
+
+int Engine::searchNode(Position& position, int depth, int alpha, int beta, int ply) {
+    nodes++;
+    if ((nodes & 1023) == 0 && checkLimits())
+        stopped = true;
+    if (stopped)
+        return 0;
+
+    MoveList& listMoves = arenaMoveLists[ply];
+    generateMoves(position, listMoves);
+    AllocationCounter::assertNoneSince(countAllocationsSearchStart);
+
+    // A team that can't move has lost, the sooner the better for the other team.
+    if (listMoves.empty())
+        return -scoreWin + ply;
+
+    if (depth <= 0)
+        return evaluate(position);
+
+    int scoreBest = -scoreWin - 1;
+    for (auto& move : listMoves) {
+        Position& positionChild = arenaPositions[ply + 1];
+        positionChild = position;
+        applyMove(positionChild, move);
+
+        // A capture sequence keeps the same team to move, so the score isn't negated.
+        int score = (positionChild.teamSelectedForGameplay == position.teamSelectedForGameplay ?
+            searchNode(positionChild, depth - 1, alpha, beta, ply + 1) :
+            -searchNode(positionChild, depth - 1, -beta, -alpha, ply + 1));
+        if (stopped)
+            return 0;
+
+        if (score > scoreBest)
+            scoreBest = score;
+        if (score > alpha)
+            alpha = score;
+        if (alpha >= beta)
+            break;
+    }
+
+    return scoreBest;
+}
+
+bool Engine::checkLimits() {
+    // Always finish the first iteration so there's a move to report.
+    if (!hasMoveBestRoot)
+        return false;
+
+    if (limitsCurrent.nodes > 0 && nodes >= limitsCurrent.nodes)
+        return true;
+
+    if (limitsCurrent.movetimeMs > 0) {
+        auto timeElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - timeStart);
+        if (timeElapsed.count() >= limitsCurrent.movetimeMs)
+            return true;
+    }
+
+    return false;
+}
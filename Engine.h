@@ -0,0 +1,91 @@
+#pragma once
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Checker.h"
+#include "FixedList.h"
+
+
+
+//Plays the game without any rendering.  The rules come from Checker, and the turn handling mirrors
+//Game::checkCheckersWithMouseInput so the engine and the window always agree on what is legal.
+class Engine
+{
+public:
+	struct Position {
+		CheckerList listCheckers;
+		Checker::Team teamSelectedForGameplay = Checker::Team::red;
+		int indexCheckerInPlay = -1;
+		bool checkerInPlayCanOnlyMove2Squares = false;
+	};
+
+	struct Move {
+		int fromX = 0, fromY = 0;
+		int toX = 0, toY = 0;
+		bool isCapture = false;
+		//Ends a capture sequence early, like clicking a square the checker in play can't move to.
+		bool isPass = false;
+	};
+
+	//Far more moves than a real game position allows, checked with an assert in debug builds.
+	typedef FixedList<Move, 512> MoveList;
+
+	//A limit of zero means unlimited.
+	struct Limits {
+		int depth = 0;
+		long long nodes = 0;
+		int movetimeMs = 0;
+	};
+
+	struct Result {
+		Move moveBest;
+		bool hasMove = false;
+		int score = 0;
+		int depth = 0;
+		long long nodes = 0;
+		int timeMs = 0;
+		long long allocations = 0;
+	};
+
+	static const int scoreWin = 100000;
+	//The deepest the search can go, which sets the size of the scratch arenas.
+	static const int plyMax = 64;
+
+
+public:
+	Engine();
+
+	static Position createStartPosition();
+	static bool parsePosition(const std::string& text, Position& position);
+	static std::string formatPosition(Position& position);
+	static bool parseMove(const std::string& text, Move& move);
+	static std::string formatMove(const Move& move);
+	static bool isSameMove(const Move& a, const Move& b);
+	static void generateMoves(Position& position, MoveList& listMoves);
+	static bool applyMove(Position& position, const Move& move);
+	static int evaluate(Position& position);
+
+	Result search(Position& position, const Limits& limits, const std::function<void(const Result&)>& onIterationDone);
+
+
+private:
+	int searchNode(Position& position, int depth, int alpha, int beta, int ply);
+	bool checkLimits();
+	static int squareNumberFromPosition(int x, int y);
+	static bool positionFromSquareNumber(int squareNumber, int& x, int& y);
+	static void passTurn(Position& position);
+
+	Limits limitsCurrent;
+	long long nodes = 0;
+	bool stopped = false;
+	std::chrono::steady_clock::time_point timeStart;
+	Move moveBestRoot;
+	bool hasMoveBestRoot = false;
+
+	//Scratch space for each ply of the search, allocated once so searching never touches the heap.
+	std::vector<Position> arenaPositions;
+	std::vector<MoveList> arenaMoveLists;
+	long long countAllocationsSearchStart = 0;
+	long long countAllocationsSearch = 0;
+};
@@ -0,0 +1,29 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "EngineProtocol.h"
+#include "KingAttacks.h"
+
+
+
+int main(int argc, char* args[]) {
+	//Use one worker per hardware thread unless told otherwise with --threads.
+	int threadCount = (int)std::thread::hardware_concurrency();
+	for (int count = 1; count < argc; count++) {
+		if (std::string(args[count]) == "--threads" && count + 1 < argc)
+			threadCount = std::atoi(args[++count]);
+	}
+
+	//Build the lookup tables the rules use for kings.
+	KingAttacks::initialize();
+
+	//Speak the protocol over stdin and stdout until the client quits.
+	std::ios::sync_with_stdio(false);
+	EngineProtocol protocol(threadCount);
+	protocol.run(std::cin, std::cout);
+
+
+	return 0;
+}
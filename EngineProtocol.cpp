@@ -0,0 +1,232 @@
+#include "EngineProtocol.h"
+#include "AllocationCounter.h"
+#include <sstream>
+
+// King-only endgames, where the lookup tables for sliding kings matter most.
+static const char* listPositionsBenchKings[] = {
+    "R:RK3:BK48",
+    "R:RK1,K12:BK39,K50",
+    "B:RK5,K18,K27:BK33,K46",
+    "R:RK22,K29:BK11,K40,K44",
+    "B:RK2,K14,K36:BK15,K37,K49",
+    "R:RK7,K24,K31,K45:BK4,K20,K43,K47",
+    "R:RK28:BK23,K32",
+    "B:RK16,K19,K34,K38:BK6,K26,K30,K41",
+};
+
+EngineProtocol::EngineProtocol(int setThreadCount) :
+    threadCount(setThreadCount > 0 ? setThreadCount : 1), positionCurrent(Engine::createStartPosition()) {
+}
+
+void EngineProtocol::run(std::istream& input, std::ostream& setOutput) {
+    output = &setOutput;
+
+    // Start the workers, they sleep until a search is queued.
+    for (int count = 0; count < threadCount; count++)
+        listThreadsWorker.push_back(std::thread(&EngineProtocol::runWorker, this));
+
+    // Read commands until told to quit or the input ends.
+    bool running = true;
+    std::string line;
+    while (running && std::getline(input, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (!line.empty())
+            processCommand(line, running);
+    }
+
+    // Let the workers finish everything that was queued, then stop them.
+    waitForJobsDone();
+    {
+        std::lock_guard<std::mutex> lock(mutexJobs);
+        stopRequested = true;
+    }
+    conditionJobsQueued.notify_all();
+    for (auto& threadWorker : listThreadsWorker)
+        threadWorker.join();
+    listThreadsWorker.clear();
+
+    // Report the throughput over the time searches were running.
+    double seconds = (countPositionsSearched > 0 ?
+        std::chrono::duration<double>(timeLastJobDone - timeFirstJobQueued).count() : 0.0);
+    std::ostringstream stream;
+    stream << "stats positions=" << countPositionsSearched << " nodes=" << countNodesSearched <<
+        " seconds=" << seconds << " threads=" << threadCount <<
+        " positions/sec=" << (seconds > 0.0 ? countPositionsSearched / seconds : 0.0) <<
+        " nodes/sec=" << (seconds > 0.0 ? countNodesSearched / seconds : 0.0);
+    if (AllocationCounter::isEnabled())
+        stream << " allocations=" << countAllocationsSearched;
+    writeLine(stream.str());
+}
+
+void EngineProtocol::processCommand(const std::string& line, bool& running) {
+    std::istringstream stream(line);
+    std::string command;
+    stream >> command;
+
+    if (command == "pos") {
+        std::string text;
+        stream >> text;
+        if (!Engine::parsePosition(text, positionCurrent))
+            writeLine("error invalid position " + text);
+    }
+    else if (command == "move") {
+        // Only moves that appear in the legal move list are played.
+        std::string text;
+        Engine::MoveList listMoves;
+        while (stream >> text) {
+            Engine::Move move;
+            bool isLegal = false;
+            if (Engine::parseMove(text, move)) {
+                Engine::generateMoves(positionCurrent, listMoves);
+                for (auto& moveLegal : listMoves) {
+                    if (Engine::isSameMove(moveLegal, move)) {
+                        isLegal = Engine::applyMove(positionCurrent, moveLegal);
+                        break;
+                    }
+                }
+            }
+
+            if (!isLegal) {
+                writeLine("error illegal move " + text);
+                break;
+            }
+        }
+    }
+    else if (command == "moves") {
+        Engine::MoveList listMoves;
+        Engine::generateMoves(positionCurrent, listMoves);
+
+        std::string text = "moves";
+        for (auto& move : listMoves)
+            text += " " + Engine::formatMove(move);
+        writeLine(text);
+    }
+    else if (command == "print") {
+        writeLine("pos " + Engine::formatPosition(positionCurrent));
+    }
+    else if (command == "go") {
+        Engine::Limits limits;
+        if (parseLimits(stream, limits))
+            queueJob(positionCurrent, limits);
+    }
+    else if (command == "bench") {
+        // Queue every benchmark position as a normal search, the stats at quit give the throughput.
+        Engine::Limits limits;
+        if (parseLimits(stream, limits)) {
+            for (const char* text : listPositionsBenchKings) {
+                Engine::Position position;
+                Engine::parsePosition(text, position);
+                queueJob(position, limits);
+            }
+        }
+    }
+    else if (command == "wait") {
+        waitForJobsDone();
+        writeLine("ready");
+    }
+    else if (command == "ping") {
+        writeLine("pong");
+    }
+    else if (command == "quit") {
+        running = false;
+    }
+    else {
+        writeLine("error unknown command " + command);
+    }
+}
+
+bool EngineProtocol::parseLimits(std::istream& stream, Engine::Limits& limits) {
+    // An unknown limit is reported and skipped, but a limit without a number fails the whole command
+    // so the search doesn't quietly run with limits the client didn't ask for.
+    std::string name;
+    long long value = 0;
+    while (stream >> name) {
+        if (!(stream >> value)) {
+            writeLine("error invalid limit " + name);
+            return false;
+        }
+
+        if (name == "depth")
+            limits.depth = (int)value;
+        else if (name == "nodes")
+            limits.nodes = value;
+        else if (name == "movetime")
+            limits.movetimeMs = (int)value;
+        else
+            writeLine("error unknown limit " + name);
+    }
+
+    // Without any limit the search would never end, so fall back to a fixed depth.
+    if (limits.depth <= 0 && limits.nodes <= 0 && limits.movetimeMs <= 0)
+        limits.depth = 6;
+
+    return true;
+}
+
+void EngineProtocol::queueJob(const Engine::Position& position, const Engine::Limits& limits) {
+    {
+        std::lock_guard<std::mutex> lock(mutexJobs);
+        Job job;
+        job.id = idJobNext++;
+        job.position = position;
+        job.limits = limits;
+        if (job.id == 1)
+            timeFirstJobQueued = std::chrono::steady_clock::now();
+        queueJobs.push_back(job);
+    }
+    conditionJobsQueued.notify_one();
+}
+
+void EngineProtocol::runWorker() {
+    // Each worker has its own engine so searches never share state.
+    Engine engine;
+
+    std::unique_lock<std::mutex> lock(mutexJobs);
+    while (true) {
+        conditionJobsQueued.wait(lock, [this] { return !queueJobs.empty() || stopRequested; });
+        if (queueJobs.empty())
+            return;
+
+        Job job = queueJobs.front();
+        queueJobs.pop_front();
+        countJobsActive++;
+        lock.unlock();
+
+        int id = job.id;
+        Engine::Result result = engine.search(job.position, job.limits, [this, id](const Engine::Result& resultIteration) {
+            std::ostringstream stream;
+            stream << "info id=" << id << " depth=" << resultIteration.depth << " score=" << resultIteration.score <<
+                " nodes=" << resultIteration.nodes << " time=" << resultIteration.timeMs <<
+                " move=" << Engine::formatMove(resultIteration.moveBest);
+            writeLine(stream.str());
+            });
+
+        std::ostringstream stream;
+        stream << "bestmove id=" << id << " move=" << (result.hasMove ? Engine::formatMove(result.moveBest) : "none") <<
+            " score=" << result.score << " depth=" << result.depth << " nodes=" << result.nodes << " time=" << result.timeMs;
+        if (AllocationCounter::isEnabled())
+            stream << " allocations=" << result.allocations;
+        writeLine(stream.str());
+
+        lock.lock();
+        countJobsActive--;
+        countPositionsSearched++;
+        countNodesSearched += result.nodes;
+        countAllocationsSearched += result.allocations;
+        timeLastJobDone = std::chrono::steady_clock::now();
+        if (queueJobs.empty() && countJobsActive == 0)
+            conditionJobsDone.notify_all();
+    }
+}
+
+void EngineProtocol::writeLine(const std::string& line) {
+    // Workers write from their own threads, so keep whole lines together.
+    std::lock_guard<std::mutex> lock(mutexOutput);
+    *output << line << std::endl;
+}
+
+void EngineProtocol::waitForJobsDone() {
+    std::unique_lock<std::mutex> lock(mutexJobs);
+    conditionJobsDone.wait(lock, [this] { return queueJobs.empty() && countJobsActive == 0; });
+}
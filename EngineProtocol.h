@@ -0,0 +1,64 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Engine.h"
+
+
+
+//Line based text protocol for driving the engine from other programs.  Searches are queued and run on
+//a pool of worker threads, so a client can send many "go" commands without waiting and each result is
+//tagged with the id of the search it belongs to.
+//
+//  pos startpos | pos <R|B>:R<squares>:B<squares>   Set the position, e.g. "pos B:R1,2,K13:B46,50".
+//  move <move> [<move> ...]                          Play moves on the position, e.g. "move 7-12 12x23".
+//                                                    "pass" ends a capture sequence early.
+//  moves                                             List the legal moves.
+//  print                                             Show the position.
+//  go [depth <n>] [nodes <n>] [movetime <ms>]        Queue a search of the position, ids count up from 1.
+//  bench [depth <n>] [nodes <n>] [movetime <ms>]     Queue searches of the built-in king-only positions.
+//  wait                                              Reply "ready" once every queued search is done.
+//  ping                                              Reply "pong" straight away.
+//  quit                                              Finish the queued searches, print stats and exit.
+class EngineProtocol
+{
+public:
+	EngineProtocol(int setThreadCount);
+	void run(std::istream& input, std::ostream& output);
+
+
+private:
+	struct Job {
+		int id;
+		Engine::Position position;
+		Engine::Limits limits;
+	};
+
+	void processCommand(const std::string& line, bool& running);
+	bool parseLimits(std::istream& stream, Engine::Limits& limits);
+	void queueJob(const Engine::Position& position, const Engine::Limits& limits);
+	void runWorker();
+	void writeLine(const std::string& line);
+	void waitForJobsDone();
+
+	int threadCount;
+	std::ostream* output = nullptr;
+	Engine::Position positionCurrent;
+	int idJobNext = 1;
+
+	std::deque<Job> queueJobs;
+	int countJobsActive = 0;
+	bool stopRequested = false;
+	std::mutex mutexJobs;
+	std::condition_variable conditionJobsQueued, conditionJobsDone;
+	std::mutex mutexOutput;
+	std::vector<std::thread> listThreadsWorker;
+
+	long long countPositionsSearched = 0, countNodesSearched = 0, countAllocationsSearched = 0;
+	std::chrono::steady_clock::time_point timeFirstJobQueued, timeLastJobDone;
+};
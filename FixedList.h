@@ -0,0 +1,46 @@
+#pragma once
+#include <cassert>
+
+
+
+//A list that keeps its items inside the object instead of on the heap, so adding, removing and copying
+//never allocates.  It follows the parts of std::vector the game uses, but can hold at most itemsMax items.
+template<typename T, int itemsMax>
+class FixedList
+{
+public:
+	int size() const { return count; }
+	bool empty() const { return count == 0; }
+	bool full() const { return count == itemsMax; }
+	static int capacity() { return itemsMax; }
+
+	void clear() { count = 0; }
+
+	void push_back(const T& item) {
+		assert(count < itemsMax);
+		if (count < itemsMax)
+			items[count++] = item;
+	}
+
+	void erase(T* item) {
+		//Shift everything after the item down so the order of the remaining items is kept.
+		for (T* itemNext = item + 1; itemNext < items + count; itemNext++)
+			*(itemNext - 1) = *itemNext;
+		count--;
+	}
+
+	int indexOf(const T* item) const { return (int)(item - items); }
+
+	T& operator[](int index) { return items[index]; }
+	const T& operator[](int index) const { return items[index]; }
+
+	T* begin() { return items; }
+	T* end() { return items + count; }
+	const T* begin() const { return items; }
+	const T* end() const { return items + count; }
+
+
+private:
+	T items[itemsMax];
+	int count = 0;
+};
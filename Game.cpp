@@ -1,9 +1,11 @@
 #include "Game.h"
+#include "AllocationCounter.h"
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
-Game::Game(SDL_Window* window, SDL_Renderer* renderer, int boardSizePixels) :
-    squareSizePixels(boardSizePixels / (10 + 6)), gameModeCurrent(GameMode::playing) {
+Game::Game(SDL_Window* window, SDL_Renderer* renderer, bool setShowFrameTimes) :
+    gameModeCurrent(GameMode::playing), showFrameTimes(setShowFrameTimes) {
     // Run the game.
     if (window != nullptr && renderer != nullptr) {
         // Load the textures for the checkers.
@@ -15,16 +17,33 @@ Game::Game(SDL_Window* window, SDL_Renderer* renderer, int boardSizePixels) :
         textureTeamRedWon = TextureLoader::loadTexture("Team Red Won Text.bmp", renderer);
         textureTeamBlueWon = TextureLoader::loadTexture("Team Blue Won Text.bmp", renderer);
 
-        resetBoard();
+        // Resume the last game if there is one, otherwise start a new one.
+        if (!loadGame("autosave.sav"))
+            resetBoard();
 
         // Start the game loop and run until it's time to stop.
         bool running = true;
         while (running) {
+            long long countAllocationsFrameStart = AllocationCounter::getCount();
+
             processEvents(running);
+            if (boardGeometryNeedsUpdate)
+                updateBoardGeometry(window, renderer);
+
+            Uint64 timeDrawStart = SDL_GetPerformanceCounter();
             draw(renderer);
+            Uint64 timeDraw = SDL_GetPerformanceCounter() - timeDrawStart;
+
+            // A frame, including any move made during it, shouldn't need the heap.
+            AllocationCounter::assertNoneSince(countAllocationsFrameStart);
+
+            // Printing is left out of the frame above since the stream may allocate.
+            if (showFrameTimes)
+                reportFrameTimes(renderer, timeDraw);
         }
 
         // Deallocate the textures.
+        Checker::destroyScaledTextures();
         TextureLoader::deallocateTextures();
     }
 }
@@ -51,6 +70,16 @@ void Game::processEvents(bool& running) {
             mouseDownStatus = 0;
             break;
 
+        case SDL_WINDOWEVENT:
+            if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+                boardGeometryNeedsUpdate = true;
+            break;
+
+        case SDL_RENDER_TARGETS_RESET:
+            // The contents of the scaled textures were lost, so they need to be created again.
+            boardGeometryNeedsUpdate = true;
+            break;
+
         case SDL_KEYDOWN:
             switch (event.key.keysym.scancode) {
             case SDL_SCANCODE_ESCAPE:
@@ -59,6 +88,24 @@ void Game::processEvents(bool& running) {
 
             case SDL_SCANCODE_R:
                 resetBoard();
+                autosave();
+                break;
+
+            case SDL_SCANCODE_S:
+                snapshotQuicksave = createSnapshot();
+                hasSnapshotQuicksave = true;
+                saveStateWriterQuicksave.submit(snapshotQuicksave);
+                break;
+
+            case SDL_SCANCODE_L:
+                // Use the quicksave from this session if there is one, the file may still be waiting to be written.
+                if (hasSnapshotQuicksave) {
+                    restoreSnapshot(snapshotQuicksave);
+                    autosave();
+                }
+                else if (loadGame("quicksave.sav")) {
+                    autosave();
+                }
                 break;
             }
         }
@@ -69,10 +116,10 @@ void Game::processEvents(bool& running) {
         int mouseX = 0, mouseY = 0;
         SDL_GetMouseState(&mouseX, &mouseY);
         // Convert from the window's coordinate system to the game's coordinate system.
-        int offsetX = 192;
-        int offsetY = 192;
-        int squareX = ((mouseX - offsetX) / squareSizePixels);
-        int squareY = ((mouseY - offsetY) / squareSizePixels);
+        int pixelX = (int)(mouseX * pixelsPerPointX);
+        int pixelY = (int)(mouseY * pixelsPerPointY);
+        int squareX = ((pixelX - boardOffsetX) / squareSizePixels);
+        int squareY = ((pixelY - boardOffsetY) / squareSizePixels);
 		cout << "SquareX: " << squareX << " SquareY: " << squareY << endl;
 
         if (gameModeCurrent == GameMode::playing)
@@ -150,6 +197,7 @@ void Game::checkCheckersWithMouseInput(int x, int y) { //newly modified on the d
                 break;
             }
             checkWin();
+            autosave();
         }
     }
 }
@@ -178,15 +226,15 @@ void Game::draw(SDL_Renderer* renderer) {
     SDL_RenderClear(renderer);
 
     if (textureCheckerBoard != nullptr)
-        SDL_RenderCopy(renderer, textureCheckerBoard, NULL, NULL);
+        SDL_RenderCopy(renderer, textureCheckerBoard, NULL, &rectBoard);
 
     // Draw the checkers.
     for (auto& checkerSelected : listCheckers)
-        checkerSelected.draw(renderer, squareSizePixels);
+        checkerSelected.draw(renderer, squareSizePixels, boardOffsetX, boardOffsetY);
 
     // If a checker is selected then draw its possible moves.
     if (indexCheckerInPlay > -1 && indexCheckerInPlay < listCheckers.size())
-        listCheckers[indexCheckerInPlay].drawPossibleMoves(renderer, squareSizePixels, listCheckers, checkerInPlayCanOnlyMove2Squares);
+        listCheckers[indexCheckerInPlay].drawPossibleMoves(renderer, squareSizePixels, boardOffsetX, boardOffsetY, listCheckers, checkerInPlayCanOnlyMove2Squares);
 
     // If the game has ended then draw an image that has a black overlay with white text that indicates the winner.
     // Select the correct texture to be drawn.
@@ -199,17 +247,70 @@ void Game::draw(SDL_Renderer* renderer) {
 
     // Draw the texture overlay if needed.
     if (textureDrawSelected != nullptr)
-        SDL_RenderCopy(renderer, textureDrawSelected, NULL, NULL);
+        SDL_RenderCopy(renderer, textureDrawSelected, NULL, &rectBoard);
 
     // Send the image to the window.
     SDL_RenderPresent(renderer);
 }
 
+void Game::updateBoardGeometry(SDL_Window* window, SDL_Renderer* renderer) {
+    // Work in real pixels so the board stays sharp on high-DPI displays.
+    int outputWidth = 0, outputHeight = 0, windowWidth = 0, windowHeight = 0;
+    SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight);
+    SDL_GetWindowSize(window, &windowWidth, &windowHeight);
+    if (windowWidth > 0 && windowHeight > 0) {
+        pixelsPerPointX = (float)outputWidth / windowWidth;
+        pixelsPerPointY = (float)outputHeight / windowHeight;
+    }
+
+    // The board image is 16 squares wide, the 10 playable squares plus a border of 3 on each side.
+    // Fit it in the window and center it.
+    squareSizePixels = std::max(1, std::min(outputWidth, outputHeight) / (10 + 6));
+    rectBoard.w = squareSizePixels * (10 + 6);
+    rectBoard.h = squareSizePixels * (10 + 6);
+    rectBoard.x = (outputWidth - rectBoard.w) / 2;
+    rectBoard.y = (outputHeight - rectBoard.h) / 2;
+    boardOffsetX = rectBoard.x + squareSizePixels * 3;
+    boardOffsetY = rectBoard.y + squareSizePixels * 3;
+
+    // Scale the checker textures to the new square size.
+    Checker::updateScaledTextures(renderer, squareSizePixels);
+
+    boardGeometryNeedsUpdate = false;
+}
+
+void Game::reportFrameTimes(SDL_Renderer* renderer, Uint64 timeDraw) {
+    timeFramesDrawing += timeDraw;
+    countFramesDrawn++;
+
+    Uint64 timeNow = SDL_GetPerformanceCounter();
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    if (timeFramesReportStart == 0)
+        timeFramesReportStart = timeNow;
+    if (timeNow - timeFramesReportStart < frequency)
+        return;
+
+    // Vsync is off while timing, so drawing and presenting waits on the GPU rather than the display
+    // and the average follows the cost of the frame at the current resolution.
+    int outputWidth = 0, outputHeight = 0;
+    SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight);
+    double seconds = (double)(timeNow - timeFramesReportStart) / frequency;
+    cout << "Frame times: " << outputWidth << "x" << outputHeight << " frames=" << countFramesDrawn <<
+        " frames/sec=" << countFramesDrawn / seconds <<
+        " draw ms=" << 1000.0 * timeFramesDrawing / frequency / std::max(countFramesDrawn, 1) << endl;
+
+    timeFramesDrawing = 0;
+    timeFramesReportStart = timeNow;
+    countFramesDrawn = 0;
+}
+
 void Game::resetBoard() {
     // Reset the game variables.
     gameModeCurrent = GameMode::playing;
     listCheckers.clear();
     teamSelectedForGameplay = Checker::Team::red;
+    indexCheckerInPlay = -1;
+    checkerInPlayCanOnlyMove2Squares = false;
 
     // Loop through the entire board and place checkers in the black squares on the first and last three rows.
     for (int x = 0; x < 10; x++) {
@@ -253,3 +354,39 @@ bool Game::teamStillHasAtLeastOneMoveLeft(Checker::Team team) {
 
     return false;
 }
+
+
+SaveState::Snapshot Game::createSnapshot() {
+    // Copy the complete game state into a snapshot that can be written to disk.
+    SaveState::Snapshot snapshot = {};
+    snapshot.gameMode = (uint8_t)gameModeCurrent;
+    snapshot.teamSelectedForGameplay = (uint8_t)teamSelectedForGameplay;
+    snapshot.indexCheckerInPlay = (int8_t)indexCheckerInPlay;
+    snapshot.checkerInPlayCanOnlyMove2Squares = checkerInPlayCanOnlyMove2Squares ? 1 : 0;
+    SaveState::storeCheckers(snapshot, listCheckers);
+
+    return snapshot;
+}
+
+void Game::restoreSnapshot(const SaveState::Snapshot& snapshot) {
+    gameModeCurrent = (GameMode)snapshot.gameMode;
+    teamSelectedForGameplay = (Checker::Team)snapshot.teamSelectedForGameplay;
+    indexCheckerInPlay = snapshot.indexCheckerInPlay;
+    checkerInPlayCanOnlyMove2Squares = (snapshot.checkerInPlayCanOnlyMove2Squares != 0);
+    SaveState::loadCheckers(snapshot, listCheckers);
+}
+
+bool Game::loadGame(const char* filename) {
+    // Only replace the current game if the file holds a valid snapshot.
+    SaveState::Snapshot snapshot;
+    if (!SaveState::readFromFile(snapshot, filename))
+        return false;
+
+    restoreSnapshot(snapshot);
+    return true;
+}
+
+void Game::autosave() {
+    // The file is written on the writer's own thread so the frame isn't held up by disk access.
+    saveStateWriterAutosave.submit(createSnapshot());
+}
\ No newline at end of file
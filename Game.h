@@ -1,8 +1,8 @@
 #pragma once
-#include <vector>
 #include "SDL2/SDL.h"
 #include "Checker.h"
 #include "TextureLoader.h"
+#include "SaveState.h"
 
 
 
@@ -18,7 +18,7 @@ private:
 
 
 public:
-	Game(SDL_Window* window, SDL_Renderer* renderer, int boardSizePixels);
+	Game(SDL_Window* window, SDL_Renderer* renderer, bool setShowFrameTimes);
 
 
 private:
@@ -26,11 +26,17 @@ private:
 	void checkCheckersWithMouseInput(int x, int y);
 	void incrementTeamSelectedForGameplay();
 	void draw(SDL_Renderer* renderer);
+	void updateBoardGeometry(SDL_Window* window, SDL_Renderer* renderer);
+	void reportFrameTimes(SDL_Renderer* renderer, Uint64 timeDraw);
 	void resetBoard();
 	void checkWin();
 	bool teamStillHasAtLeastOneMoveLeft(Checker::Team team);
+	SaveState::Snapshot createSnapshot();
+	void restoreSnapshot(const SaveState::Snapshot& snapshot);
+	bool loadGame(const char* filename);
+	void autosave();
 
-	std::vector<Checker> listCheckers;
+	CheckerList listCheckers;
 	int indexCheckerInPlay = -1;
 	bool checkerInPlayCanOnlyMove2Squares = false;
 	Checker::Team teamSelectedForGameplay = Checker::Team::red;
@@ -38,10 +44,29 @@ private:
 
 	int mouseDownStatus = 0;
 
+	//The game is saved here after every change and resumed from here on the next launch.
+	SaveStateWriter saveStateWriterAutosave{ "autosave.sav" };
+	SaveStateWriter saveStateWriterQuicksave{ "quicksave.sav" };
+	//The last quicksave is also kept here, so loading it doesn't depend on the writer having finished.
+	SaveState::Snapshot snapshotQuicksave = {};
+	bool hasSnapshotQuicksave = false;
+
 	SDL_Texture* textureCheckerBoard = nullptr;
 	SDL_Texture* textureTeamRedWon = nullptr, * textureTeamGreenWon = nullptr,
 		* textureTeamBlueWon = nullptr, * textureTeamYellowWon = nullptr;
 
-	//The size of each squares on the board in pixels.
-	const int squareSizePixels;
+	//The size of each squares on the board in pixels, and where the board and its playable area start.
+	//These follow the size of the window and are updated whenever it changes.
+	int squareSizePixels = 0;
+	SDL_Rect rectBoard = { 0, 0, 0, 0 };
+	int boardOffsetX = 0, boardOffsetY = 0;
+	bool boardGeometryNeedsUpdate = true;
+
+	//Mouse positions are in window points, which can differ from pixels on high-DPI displays.
+	float pixelsPerPointX = 1.0f, pixelsPerPointY = 1.0f;
+
+	//When enabled, the time spent drawing each frame is added up and the average is printed once a second.
+	bool showFrameTimes = false;
+	Uint64 timeFramesDrawing = 0, timeFramesReportStart = 0;
+	int countFramesDrawn = 0;
 };
@@ -0,0 +1,260 @@
+#include "KingAttacks.h"
+#include <algorithm>
+#include <cassert>
+
+// _pext_u64 only exists in 64 bit builds.  PEXT is also very slow on AMD CPUs before Zen 3, so defining
+// KING_ATTACKS_NO_PEXT uses the magic numbers even when BMI2 is available.
+#if !defined(KING_ATTACKS_NO_PEXT) && \
+    ((defined(__BMI2__) && defined(__x86_64__)) || (defined(_MSC_VER) && defined(_M_X64) && defined(__AVX2__)))
+#define KING_ATTACKS_USE_PEXT
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+KingAttacks::Diagonal KingAttacks::listDiagonals[50][2];
+std::vector<KingAttacks::Entry> KingAttacks::listEntries;
+
+#ifndef KING_ATTACKS_USE_PEXT
+// The magic number and shift for each square and diagonal.  They were found once by trying sparse random
+// numbers until one sent every occupancy of the diagonal to its own slot, or to a slot holding an identical
+// entry, so they don't have to be searched for every time the program starts.
+static const struct {
+    uint64_t magic;
+    int shift;
+} listMagics[50][2] = {
+    { { 0x0600702040101000ULL, 55 }, { 0x0000010400906141ULL, 63 } },
+    { { 0x0080402090802008ULL, 57 }, { 0x0220020801010000ULL, 62 } },
+    { { 0x0181048041004a80ULL, 59 }, { 0x4105013c01004140ULL, 60 } },
+    { { 0x0481880200110000ULL, 61 }, { 0x0420826080121807ULL, 58 } },
+    { { 0x0046200458400000ULL, 63 }, { 0x2210420080a00130ULL, 56 } },
+    { { 0x480340040040c004ULL, 55 }, { 0x5014104000200002ULL, 62 } },
+    { { 0x2842040800800000ULL, 57 }, { 0x28082800a0100000ULL, 60 } },
+    { { 0x0802042c04000020ULL, 59 }, { 0x8404304200120220ULL, 58 } },
+    { { 0x0820b050000100c0ULL, 61 }, { 0x450040100c201008ULL, 56 } },
+    { { 0x1800022001201104ULL, 63 }, { 0x0941040404040000ULL, 56 } },
+    { { 0x0800420210108000ULL, 57 }, { 0x4600100800000002ULL, 62 } },
+    { { 0x4400502010802000ULL, 55 }, { 0x4900280480010080ULL, 60 } },
+    { { 0x0810400408100044ULL, 57 }, { 0xc4a040c080020021ULL, 58 } },
+    { { 0x3412084401240210ULL, 59 }, { 0x0040082004201808ULL, 56 } },
+    { { 0x10400400388b2000ULL, 61 }, { 0x801002a208020000ULL, 56 } },
+    { { 0x60a0092202022000ULL, 57 }, { 0x2086040000040000ULL, 60 } },
+    { { 0x0201001000403010ULL, 55 }, { 0x0901002082012400ULL, 58 } },
+    { { 0x8100802804400008ULL, 57 }, { 0x0880802808010016ULL, 56 } },
+    { { 0xa48405a908000800ULL, 59 }, { 0x2000802048060004ULL, 56 } },
+    { { 0x50c0880501210094ULL, 61 }, { 0x0600004044084008ULL, 58 } },
+    { { 0x0086046098082210ULL, 59 }, { 0x1204240080800200ULL, 60 } },
+    { { 0x8008200084080808ULL, 57 }, { 0x2101410880420220ULL, 58 } },
+    { { 0x0100800900402008ULL, 55 }, { 0x0c8020040c018110ULL, 56 } },
+    { { 0x8a00e00088204004ULL, 57 }, { 0x0040500102008030ULL, 56 } },
+    { { 0x024404420081025aULL, 59 }, { 0x4400041418620000ULL, 58 } },
+    { { 0x0002020428101140ULL, 59 }, { 0x0083808082806000ULL, 58 } },
+    { { 0x28440c004041a040ULL, 57 }, { 0x1301010210040820ULL, 56 } },
+    { { 0x2280402001804001ULL, 55 }, { 0x019004a018020024ULL, 56 } },
+    { { 0x9044010082080800ULL, 57 }, { 0x0001022004030004ULL, 58 } },
+    { { 0x1111048090000008ULL, 59 }, { 0x0040028410504001ULL, 60 } },
+    { { 0x250804200840c104ULL, 61 }, { 0x0100409000014010ULL, 58 } },
+    { { 0x08c0081004022620ULL, 59 }, { 0x11802008013000d8ULL, 56 } },
+    { { 0x8212401000808080ULL, 57 }, { 0x0218200802901006ULL, 56 } },
+    { { 0x2140101001802004ULL, 55 }, { 0x1145240800890000ULL, 58 } },
+    { { 0x30a0600800200a00ULL, 57 }, { 0x4020800201504080ULL, 60 } },
+    { { 0x8000008100c28044ULL, 61 }, { 0x28c0400940101000ULL, 56 } },
+    { { 0x6082c85010048000ULL, 59 }, { 0x0028200801010026ULL, 56 } },
+    { { 0x0029008808404000ULL, 57 }, { 0x2510100418082212ULL, 58 } },
+    { { 0x0100403000410400ULL, 55 }, { 0x0842012710102805ULL, 60 } },
+    { { 0x0880202802080402ULL, 57 }, { 0xc0082a001d048058ULL, 62 } },
+    { { 0x00000242100d0900ULL, 63 }, { 0x0140182024008006ULL, 56 } },
+    { { 0x0340f020989e3145ULL, 61 }, { 0xd000a00802008030ULL, 56 } },
+    { { 0x00c0141011410100ULL, 59 }, { 0x04002c1040410011ULL, 58 } },
+    { { 0x8080808804000884ULL, 57 }, { 0x1448a44220842861ULL, 60 } },
+    { { 0x4410010010203800ULL, 55 }, { 0x0001042040828880ULL, 62 } },
+    { { 0x0000000800900004ULL, 63 }, { 0x1040240802041280ULL, 56 } },
+    { { 0x0000000490601400ULL, 61 }, { 0x4016140414041000ULL, 58 } },
+    { { 0x0000222062a00180ULL, 59 }, { 0x80004002214c0000ULL, 60 } },
+    { { 0x0009808814010400ULL, 57 }, { 0x0200870115040008ULL, 62 } },
+    { { 0x0200801402408000ULL, 55 }, { 0x0400040441000110ULL, 63 } }
+};
+#endif
+
+void KingAttacks::positionFromSquare(int square, int& x, int& y) {
+    y = square / 5;
+    x = (square % 5) * 2 + (y % 2);
+}
+
+int KingAttacks::popLowestSquare(uint64_t& squares) {
+    // Return the lowest square in the set and remove it.
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long square = 0;
+    _BitScanForward64(&square, squares);
+#elif defined(_MSC_VER)
+    // Other targets only have the 32 bit scan, so look at the low half first.
+    unsigned long square = 0;
+    if (!_BitScanForward(&square, (unsigned long)squares)) {
+        _BitScanForward(&square, (unsigned long)(squares >> 32));
+        square += 32;
+    }
+#else
+    int square = __builtin_ctzll(squares);
+#endif
+    squares &= squares - 1;
+    return (int)square;
+}
+
+uint64_t KingAttacks::getOccupancy(CheckerList& listCheckers, Checker::Team team, uint64_t& occupancyOpponent) {
+    // Return every occupied square, and separately the squares held by the other team.
+    uint64_t occupancy = 0;
+    occupancyOpponent = 0;
+    for (auto& checker : listCheckers) {
+        uint64_t square = 1ULL << squareFromPosition(checker.getPosX(), checker.getPosY());
+        occupancy |= square;
+        if (checker.getTeam() != team)
+            occupancyOpponent |= square;
+    }
+
+    return occupancy;
+}
+
+const KingAttacks::Ray& KingAttacks::getRay(int x, int y, int xDirection, int yDirection, uint64_t occupancy) {
+    int diagonal = (xDirection == yDirection ? 0 : 1);
+    return lookup(squareFromPosition(x, y), diagonal, occupancy).rays[xDirection > 0 ? 0 : 1];
+}
+
+void KingAttacks::getKingMoves(int square, uint64_t occupancy, uint64_t occupancyOpponent,
+    uint64_t& squaresQuiet, uint64_t& squaresLanding) {
+    // One lookup per diagonal gives both directions at once.
+    squaresQuiet = 0;
+    squaresLanding = 0;
+    for (int diagonal = 0; diagonal < 2; diagonal++) {
+        const Entry& entry = lookup(square, diagonal, occupancy);
+        squaresQuiet |= entry.squaresEmpty;
+
+        // A capture needs an opponent blocking the way and an empty square right behind it.
+        for (const Ray& ray : entry.rays) {
+            if (ray.squareLanding != -1 && (occupancyOpponent >> ray.squareBlocker) & 1)
+                squaresLanding |= 1ULL << ray.squareLanding;
+        }
+    }
+}
+
+const KingAttacks::Entry& KingAttacks::lookup(int square, int diagonal, uint64_t occupancy) {
+    const Diagonal& diagonalSelected = listDiagonals[square][diagonal];
+#ifdef KING_ATTACKS_USE_PEXT
+    uint64_t index = _pext_u64(occupancy, diagonalSelected.mask);
+#else
+    uint64_t index = ((occupancy & diagonalSelected.mask) * diagonalSelected.magic) >> diagonalSelected.shift;
+#endif
+    return listEntries[diagonalSelected.indexFirstEntry + (int)index];
+}
+
+void KingAttacks::initialize() {
+    if (!listEntries.empty())
+        return;
+
+#ifndef KING_ATTACKS_USE_PEXT
+    auto isSameEntry = [](const Entry& a, const Entry& b) {
+        for (int direction = 0; direction < 2; direction++) {
+            if (a.rays[direction].distanceEmpty != b.rays[direction].distanceEmpty ||
+                a.rays[direction].squareBlocker != b.rays[direction].squareBlocker ||
+                a.rays[direction].squareLanding != b.rays[direction].squareLanding)
+                return false;
+        }
+        return a.squaresEmpty == b.squaresEmpty;
+    };
+    bool magicsFit = true;
+#endif
+
+    for (int square = 0; square < 50; square++) {
+        int x = 0, y = 0;
+        positionFromSquare(square, x, y);
+
+        for (int diagonal = 0; diagonal < 2; diagonal++) {
+            // Direction 0 moves right along the diagonal and direction 1 moves left.
+            int xDirections[2] = { 1, -1 };
+            int yDirections[2] = { (diagonal == 0 ? 1 : -1), (diagonal == 0 ? -1 : 1) };
+
+            // The mask is every square on the diagonal except the king's own, out to both edges, since a
+            // capture depends on whether the square behind the blocker is empty.
+            uint64_t mask = 0;
+            for (int direction = 0; direction < 2; direction++) {
+                for (int xRay = x + xDirections[direction], yRay = y + yDirections[direction];
+                    xRay >= 0 && xRay < 10 && yRay >= 0 && yRay < 10;
+                    xRay += xDirections[direction], yRay += yDirections[direction])
+                    mask |= 1ULL << squareFromPosition(xRay, yRay);
+            }
+
+            // A corner square has an empty diagonal, but it still gets one bit so the shift stays below 64.
+            int countBits = 0;
+            for (uint64_t squares = mask; squares != 0; squares &= squares - 1)
+                countBits++;
+            countBits = std::max(countBits, 1);
+
+            Diagonal& diagonalSelected = listDiagonals[square][diagonal];
+            diagonalSelected.mask = mask;
+#ifdef KING_ATTACKS_USE_PEXT
+            diagonalSelected.magic = 0;
+            diagonalSelected.shift = 64 - countBits;
+#else
+            diagonalSelected.magic = listMagics[square][diagonal].magic;
+            diagonalSelected.shift = listMagics[square][diagonal].shift;
+#endif
+            diagonalSelected.indexFirstEntry = (int)listEntries.size();
+
+            int countEntries = 1 << countBits;
+            listEntries.resize(listEntries.size() + countEntries);
+            Entry* entries = &listEntries[diagonalSelected.indexFirstEntry];
+#ifndef KING_ATTACKS_USE_PEXT
+            std::vector<bool> listSlotsUsed(countEntries);
+#endif
+
+            // Work out the entry for every combination of occupied squares on the diagonal.
+            uint64_t occupancy = 0;
+            do {
+                Entry entry = {};
+                for (int direction = 0; direction < 2; direction++) {
+                    Ray& ray = entry.rays[direction];
+                    ray.distanceEmpty = 0;
+                    ray.squareBlocker = -1;
+                    ray.squareLanding = -1;
+
+                    int xRay = x + xDirections[direction], yRay = y + yDirections[direction];
+                    for (; xRay >= 0 && xRay < 10 && yRay >= 0 && yRay < 10;
+                        xRay += xDirections[direction], yRay += yDirections[direction]) {
+                        int squareRay = squareFromPosition(xRay, yRay);
+                        if ((occupancy >> squareRay) & 1) {
+                            ray.squareBlocker = (int8_t)squareRay;
+                            break;
+                        }
+                        entry.squaresEmpty |= 1ULL << squareRay;
+                        ray.distanceEmpty++;
+                    }
+
+                    // The landing square is right behind the blocker and has to be empty.
+                    int xLanding = xRay + xDirections[direction], yLanding = yRay + yDirections[direction];
+                    if (ray.squareBlocker != -1 && xLanding >= 0 && xLanding < 10 && yLanding >= 0 && yLanding < 10 &&
+                        !((occupancy >> squareFromPosition(xLanding, yLanding)) & 1))
+                        ray.squareLanding = (int8_t)squareFromPosition(xLanding, yLanding);
+                }
+
+#ifdef KING_ATTACKS_USE_PEXT
+                entries[_pext_u64(occupancy, mask)] = entry;
+#else
+                // Occupancies can only share a slot if they give the same entry.
+                uint64_t slot = (occupancy * diagonalSelected.magic) >> diagonalSelected.shift;
+                if (listSlotsUsed[slot])
+                    magicsFit = magicsFit && isSameEntry(entries[slot], entry);
+                listSlotsUsed[slot] = true;
+                entries[slot] = entry;
+#endif
+                occupancy = (occupancy - mask) & mask;
+            } while (occupancy != 0);
+        }
+    }
+
+#ifndef KING_ATTACKS_USE_PEXT
+    // The magic numbers only fit these masks, if the masks change they have to be found again.
+    assert(magicsFit && "Magic numbers don't fit the diagonal masks.");
+    (void)magicsFit;
+#endif
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Checker.h"
+
+
+
+//Precomputed tables for the moves of a king, which can slide any distance along a diagonal.  The 50
+//dark squares are numbered 0 to 49 row by row, and a board is a 64 bit set of those squares.  For
+//each square and each of its two diagonals, the occupied squares along that diagonal select an entry
+//that already holds how far the king can slide in both directions, what stops it and where it would
+//land if it captured.  The occupancy is turned into an index with PEXT when BMI2 is available in a 64
+//bit build and KING_ATTACKS_NO_PEXT isn't defined, and with a multiply and shift by a "magic" number otherwise.  initialize() builds the tables and has to be
+//called once before any moves are looked up.
+class KingAttacks
+{
+public:
+	//One direction along a diagonal.  A square is -1 when there isn't one.
+	struct Ray {
+		int8_t distanceEmpty;
+		int8_t squareBlocker;
+		int8_t squareLanding;
+	};
+
+	struct Entry {
+		uint64_t squaresEmpty;
+		Ray rays[2];
+	};
+
+
+public:
+	static void initialize();
+	static int squareFromPosition(int x, int y) { return y * 5 + x / 2; }
+	static void positionFromSquare(int square, int& x, int& y);
+	static int popLowestSquare(uint64_t& squares);
+
+	static uint64_t getOccupancy(CheckerList& listCheckers, Checker::Team team, uint64_t& occupancyOpponent);
+	static const Ray& getRay(int x, int y, int xDirection, int yDirection, uint64_t occupancy);
+	static void getKingMoves(int square, uint64_t occupancy, uint64_t occupancyOpponent,
+		uint64_t& squaresQuiet, uint64_t& squaresLanding);
+
+
+private:
+	struct Diagonal {
+		uint64_t mask;
+		uint64_t magic;
+		int shift;
+		int indexFirstEntry;
+	};
+
+	static const Entry& lookup(int square, int diagonal, uint64_t occupancy);
+
+	//Diagonal 0 runs from top left to bottom right, diagonal 1 from bottom left to top right.
+	static Diagonal listDiagonals[50][2];
+	static std::vector<Entry> listEntries;
+};
@@ -0,0 +1,176 @@
+#include "SaveState.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+const char SaveState::magicExpected[4] = { 'C', 'K', 'S', 'V' };
+
+void SaveState::storeCheckers(Snapshot& snapshot, CheckerList& listCheckers) {
+    // Anything that doesn't fit is left out, isValid() would reject such a board anyway.
+    int count = std::min(listCheckers.size(), (int)maxCheckers);
+    snapshot.checkerCount = (uint8_t)count;
+
+    for (int i = 0; i < count; i++) {
+        Snapshot::Piece& piece = snapshot.pieces[i];
+        piece.posX = (uint8_t)listCheckers[i].getPosX();
+        piece.posY = (uint8_t)listCheckers[i].getPosY();
+        piece.team = (uint8_t)listCheckers[i].getTeam();
+        piece.isAKing = listCheckers[i].getIsAKing() ? 1 : 0;
+    }
+
+    // Zero the unused slots so identical boards always produce identical files.
+    memset(snapshot.pieces + count, 0, sizeof(Snapshot::Piece) * (maxCheckers - count));
+}
+
+void SaveState::loadCheckers(const Snapshot& snapshot, CheckerList& listCheckers) {
+    listCheckers.clear();
+    for (int i = 0; i < snapshot.checkerCount; i++) {
+        const Snapshot::Piece& piece = snapshot.pieces[i];
+        listCheckers.push_back(Checker(piece.posX, piece.posY, (Checker::Team)piece.team, piece.isAKing != 0));
+    }
+}
+
+bool SaveState::isValid(const Snapshot& snapshot) {
+    if (memcmp(snapshot.magic, magicExpected, sizeof(magicExpected)) != 0 ||
+        snapshot.version != versionCurrent)
+        return false;
+
+    // Game mode is playing, red won or blue won, and the team is red or blue.
+    if (snapshot.gameMode > 2 || snapshot.teamSelectedForGameplay > 1 ||
+        snapshot.checkerInPlayCanOnlyMove2Squares > 1 || snapshot.checkerCount > maxCheckers)
+        return false;
+
+    // The checker in play must exist, and a capture in progress needs a checker in play.
+    if (snapshot.indexCheckerInPlay < -1 || snapshot.indexCheckerInPlay >= snapshot.checkerCount)
+        return false;
+    if (snapshot.checkerInPlayCanOnlyMove2Squares && snapshot.indexCheckerInPlay == -1)
+        return false;
+
+    // Only the team whose turn it is can have a checker in play, otherwise the wrong side could move it.
+    if (snapshot.indexCheckerInPlay != -1 &&
+        snapshot.pieces[snapshot.indexCheckerInPlay].team != snapshot.teamSelectedForGameplay)
+        return false;
+
+    // Every checker must be on its own dark square.
+    bool squareOccupied[10][10] = {};
+    for (int i = 0; i < snapshot.checkerCount; i++) {
+        const Snapshot::Piece& piece = snapshot.pieces[i];
+        if (piece.posX >= 10 || piece.posY >= 10 || (piece.posX + piece.posY) % 2 != 0 ||
+            piece.team > 1 || piece.isAKing > 1 || squareOccupied[piece.posX][piece.posY])
+            return false;
+        squareOccupied[piece.posX][piece.posY] = true;
+    }
+
+    return true;
+}
+
+bool SaveState::writeToFile(const Snapshot& snapshot, const std::string& filename) {
+    // Write to a temporary file first so a crash mid-write never leaves a truncated save behind.
+    Snapshot snapshotStamped = snapshot;
+    memcpy(snapshotStamped.magic, magicExpected, sizeof(magicExpected));
+    snapshotStamped.version = versionCurrent;
+    memset(snapshotStamped.reserved, 0, sizeof(snapshotStamped.reserved));
+
+    std::string filenameTemporary = filename + ".tmp";
+    {
+        std::ofstream file(filenameTemporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&snapshotStamped), sizeof(Snapshot));
+        file.close();
+        if (!file)
+            return false;
+    }
+
+    // Replace the old save in one step, so there's always either the old or the new save on disk.
+#ifdef _WIN32
+    return MoveFileExA(filenameTemporary.c_str(), filename.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(filenameTemporary.c_str(), filename.c_str()) == 0;
+#endif
+}
+
+bool SaveState::readFromFile(Snapshot& snapshot, const char* filename) {
+    // The file is the snapshot, so restoring is a single read straight into the struct.  C file
+    // functions and a plain filename are used so loading during a frame doesn't allocate through operator new.
+    std::FILE* file = std::fopen(filename, "rb");
+    if (file == nullptr)
+        return false;
+
+    size_t countRead = std::fread(&snapshot, sizeof(Snapshot), 1, file);
+    std::fclose(file);
+
+    return (countRead == 1 && isValid(snapshot));
+}
+
+int SaveState::checkFiles(const std::vector<std::string>& filenames) {
+    // Load and validate every file, print the ones that fail, and return how many failed.
+    int countInvalid = 0;
+    Snapshot snapshot;
+
+    auto timeStart = std::chrono::steady_clock::now();
+    for (auto& filename : filenames) {
+        if (!readFromFile(snapshot, filename.c_str())) {
+            std::cout << "Invalid save = " << filename << std::endl;
+            countInvalid++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - timeStart).count();
+
+    std::cout << "Checked " << filenames.size() << " saves, " << countInvalid << " invalid, in " <<
+        seconds << "s (" << (seconds > 0.0 ? filenames.size() / seconds : 0.0) << " saves/s)" << std::endl;
+
+    return countInvalid;
+}
+
+
+
+SaveStateWriter::SaveStateWriter(const std::string& setFilename) :
+    filename(setFilename), threadWriter(&SaveStateWriter::run, this) {
+}
+
+SaveStateWriter::~SaveStateWriter() {
+    // Let the thread write whatever is still pending before it exits.
+    {
+        std::lock_guard<std::mutex> lock(mutexPending);
+        stopRequested = true;
+    }
+    conditionPending.notify_one();
+    threadWriter.join();
+}
+
+void SaveStateWriter::submit(const SaveState::Snapshot& snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(mutexPending);
+        snapshotPending = snapshot;
+        hasSnapshotPending = true;
+    }
+    conditionPending.notify_one();
+}
+
+void SaveStateWriter::run() {
+    std::unique_lock<std::mutex> lock(mutexPending);
+    while (true) {
+        conditionPending.wait(lock, [this] { return hasSnapshotPending || stopRequested; });
+
+        if (hasSnapshotPending) {
+            // Copy the snapshot out so the game can submit a new one while this one is written.
+            SaveState::Snapshot snapshotWrite = snapshotPending;
+            hasSnapshotPending = false;
+
+            lock.unlock();
+            if (!SaveState::writeToFile(snapshotWrite, filename))
+                std::cout << "Error: Couldn't write save = " << filename << std::endl;
+            lock.lock();
+        }
+        else if (stopRequested) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Checker.h"
+
+
+
+class SaveState
+{
+public:
+	//The most checkers a snapshot can hold, one for every dark square on the board.
+	static constexpr int maxCheckers = 50;
+
+	//Fixed binary layout written to disk as-is.  Every field is a single byte so the layout has no
+	//padding and no byte order, which lets a snapshot be restored with one read and no parsing.
+	struct Snapshot {
+		struct Piece {
+			uint8_t posX, posY;
+			uint8_t team;
+			uint8_t isAKing;
+		};
+
+		char magic[4];
+		uint8_t version;
+		uint8_t gameMode;
+		uint8_t teamSelectedForGameplay;
+		int8_t indexCheckerInPlay;
+		uint8_t checkerInPlayCanOnlyMove2Squares;
+		uint8_t checkerCount;
+		uint8_t reserved[2];
+		Piece pieces[maxCheckers];
+	};
+
+
+public:
+	static void storeCheckers(Snapshot& snapshot, CheckerList& listCheckers);
+	static void loadCheckers(const Snapshot& snapshot, CheckerList& listCheckers);
+	static bool isValid(const Snapshot& snapshot);
+	static bool writeToFile(const Snapshot& snapshot, const std::string& filename);
+	static bool readFromFile(Snapshot& snapshot, const char* filename);
+	static int checkFiles(const std::vector<std::string>& filenames);
+
+
+private:
+	static const char magicExpected[4];
+	static const uint8_t versionCurrent = 1;
+};
+
+static_assert(sizeof(SaveState::Snapshot) == 12 + 4 * SaveState::maxCheckers, "Snapshot layout must not contain padding.");
+
+
+
+//Writes snapshots to a file on a background thread so saving never stalls the game loop.
+//Only the newest pending snapshot is kept, older ones that haven't been written yet are dropped.
+class SaveStateWriter
+{
+public:
+	SaveStateWriter(const std::string& setFilename);
+	~SaveStateWriter();
+	void submit(const SaveState::Snapshot& snapshot);
+
+
+private:
+	void run();
+
+	std::string filename;
+	SaveState::Snapshot snapshotPending;
+	bool hasSnapshotPending = false;
+	bool stopRequested = false;
+	std::mutex mutexPending;
+	std::condition_variable conditionPending;
+	std::thread threadWriter;
+};
@@ -2,10 +2,29 @@
 #include "SDL2/SDL.h"
 
 #include "Game.h"
+#include "KingAttacks.h"
+#include "SaveState.h"
 
 
 
 int main(int argc, char* args[]) {
+	//Check save files listed on the command line instead of starting the game.
+	if (argc > 1 && std::string(args[1]) == "--check-saves")
+		return (SaveState::checkFiles(std::vector<std::string>(args + 2, args + argc)) == 0 ? 0 : 1);
+
+	//Build the lookup tables the rules use for kings.
+	KingAttacks::initialize();
+
+	//Set CHECKERS_FRAME_TIMES to print the average time spent drawing a frame, e.g. to compare window sizes.
+	bool showFrameTimes = (SDL_getenv("CHECKERS_FRAME_TIMES") != nullptr);
+
+	//On Windows SDL_WINDOW_ALLOW_HIGHDPI does nothing by itself and the system stretches the window instead,
+	//so ask for real pixels.  These have to be set before the video subsystem starts.
+#ifdef SDL_HINT_WINDOWS_DPI_AWARENESS
+	SDL_SetHint(SDL_HINT_WINDOWS_DPI_AWARENESS, "permonitorv2");
+	SDL_SetHint(SDL_HINT_WINDOWS_DPI_SCALING, "1");
+#endif
+
 	if (SDL_Init(SDL_INIT_VIDEO) < 0) {
 		std::cout << "Error: Couldn't initialize SDL Video = " << SDL_GetError() << std::endl;
 		return 1;
@@ -13,7 +32,8 @@ int main(int argc, char* args[]) {
 	else {
 		//Create the window.
 		const int boardSize = 1024;  //define size window game
-		SDL_Window* window = SDL_CreateWindow("Checkers", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, boardSize, boardSize, 0);
+		SDL_Window* window = SDL_CreateWindow("Checkers", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, boardSize, boardSize,
+			SDL_WINDOW_RESIZABLE | SDL_WINDOW_ALLOW_HIGHDPI);
 
 		if (window == nullptr) {
 			std::cout << "Error: Couldn't create window = " << SDL_GetError() << std::endl;
@@ -21,7 +41,9 @@ int main(int argc, char* args[]) {
 		}
 		else {
 			//Create a renderer for GPU accelerated drawing.
-			SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE | SDL_RENDERER_PRESENTVSYNC);
+			//Vsync is left off when timing frames, otherwise every frame would take as long as the display's refresh.
+			SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE |
+				(showFrameTimes ? 0 : SDL_RENDERER_PRESENTVSYNC));
 			if (renderer == nullptr) {
 				std::cout << "Error: Couldn't create renderer = " << SDL_GetError() << std::endl;
 				return 1;
@@ -30,7 +52,7 @@ int main(int argc, char* args[]) {
 				//Ensure transparent graphics are drawn correctly.
 				SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-				//Enable anti-aliasing to make the game look better if the window is scaled.
+				//Enable anti-aliasing so textures look good when they're scaled to fit the window.
 				SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
 
 				//Output the name of the render driver.
@@ -39,7 +61,7 @@ int main(int argc, char* args[]) {
 				std::cout << "Renderer = " << rendererInfo.name << std::endl;
 
 				//Start the game.
-				Game game(window, renderer, boardSize);
+				Game game(window, renderer, showFrameTimes);
 
 				//Clean up.
 				SDL_DestroyRenderer(renderer);